@@ -20,7 +20,7 @@ Library:		AcksenUtils
 Author: 		Richard Phillips for Acksen Ltd
 
 Created:		25 Jul 2022
-Last Modified:		25 Jul 2022
+Last Modified:		19 Oct 2026
 
 Description:
 Demonstrate via debug serial port, the usage of helper functions in the AcksenUtils library.
@@ -52,11 +52,32 @@ Demonstrate via debug serial port, the usage of helper functions in the AcksenUt
 #define TEMP_FAH_VALUE_MIN		32	// Minimum allowable Fahrenheit value
 #define TEMP_FAH_VALUE_MAX		230	// Minimum allowable Fahrenheit value
 
+#define RANGE_HISTORY_SIZE		32	// Number of samples held by the range index.  Each sample costs 16 bytes of RAM -
+						// keep this small on an Uno.  A 300 sample history needs ~5 KB, so suits a Mega or larger.
+
+#define MEDIAN_WINDOW_SIZE		5	// Number of samples in the rolling median filter window
+
 // ***********************************
 // Variables
 // ***********************************
 AcksenUtils Utilities;	// Initialise the AcksenUtils class object
 
+// Range index storage - the history and each of the three trees must hold RANGE_HISTORY_SIZE floats
+float fRangeHistory[RANGE_HISTORY_SIZE];
+float fRangeMinTree[RANGE_HISTORY_SIZE];
+float fRangeMaxTree[RANGE_HISTORY_SIZE];
+float fRangeSumTree[RANGE_HISTORY_SIZE];
+AcksenFloatRangeIndex RangeHistory(fRangeHistory, fRangeMinTree, fRangeMaxTree, fRangeSumTree, RANGE_HISTORY_SIZE);	// Initialise the range index over the history
+
+// Rolling median storage - the window and its sorted copy must each hold MEDIAN_WINDOW_SIZE values
+float fMedianWindow[MEDIAN_WINDOW_SIZE];
+float fMedianSorted[MEDIAN_WINDOW_SIZE];
+AcksenFloatRollingMedian MedianFilter(fMedianWindow, fMedianSorted, MEDIAN_WINDOW_SIZE);	// Initialise the float rolling median filter
+
+int iMedianWindow[MEDIAN_WINDOW_SIZE];
+int iMedianSorted[MEDIAN_WINDOW_SIZE];
+AcksenIntRollingMedian IntMedianFilter(iMedianWindow, iMedianSorted, MEDIAN_WINDOW_SIZE);	// Initialise the int rolling median filter
+
 // ************************************************
 // Setup 
 // ************************************************
@@ -169,4 +190,68 @@ void loop()
 	}
 	
 	
+	// *************************************************
+	// Demonstration of Range Index over a sample history
+	
+	float fWindowMin, fWindowMax, fWindowAvg, fWindowRange;
+	
+	// Add a new sample each time around the loop - once full, the oldest sample is discarded
+	RangeHistory.Add((float)random(0, 1000) / 10);
+	
+	Trace("Range History Samples = ");
+	Traceln(RangeHistory.Count());
+	
+	// Statistics for the most recent 10 samples, and for the whole history
+	if (RangeHistory.QueryLatest(fWindowMin, fWindowMax, fWindowAvg, fWindowRange, 10))
+	{
+		Trace("Last 10 Samples: Min = ");
+		Trace(fWindowMin);
+		Trace(", Max = ");
+		Trace(fWindowMax);
+		Trace(", Mean Average = ");
+		Trace(fWindowAvg);
+		Trace(", Range = ");
+		Traceln(fWindowRange);
+	}
+	
+	if (RangeHistory.QueryLatest(fWindowMin, fWindowMax, fWindowAvg, fWindowRange, RangeHistory.Count()))
+	{
+		Trace("All Samples: Min = ");
+		Trace(fWindowMin);
+		Trace(", Max = ");
+		Trace(fWindowMax);
+		Trace(", Mean Average = ");
+		Traceln(fWindowAvg);
+	}
+	Traceln("");
+	
+	// *************************************************
+	// Demonstration of Rolling Median filters
+	
+	float fReading;
+	
+	// Simulate a sensor that occasionally fails and returns NaN - these readings are ignored by the filter
+	if (random(0, 10) == 0)
+	{
+		fReading = NAN;
+	}
+	else
+	{
+		fReading = (float)random(0, 1000) / 10;
+	}
+	
+	MedianFilter.Add(fReading);
+	IntMedianFilter.Add(analogRead(A0));
+	
+	Trace("Float Reading = ");
+	Trace(fReading);
+	Trace(", Filtered Median = ");
+	Trace(MedianFilter.GetMedian());
+	Trace(", 90th Percentile = ");
+	Traceln(MedianFilter.GetPercentile(90));
+	
+	Trace("Int Reading Median = ");
+	Traceln(IntMedianFilter.GetMedian());
+	Traceln("");
+	
 }
\ No newline at end of file
@@ -42,7 +42,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 */
 /***********************************************************/
 
-// Acksen Utilities Library v1.4.0
+// Acksen Utilities Library v1.5.0
 
 #include "Arduino.h"
 #include "AcksenUtils.h"
@@ -363,4 +363,517 @@ float AcksenUtils::ConvertFahrenheitToCelsius(float fTemperature, float fMinTemp
 
 	return fTemperature;
 
+}
+
+AcksenFloatRangeIndex::AcksenFloatRangeIndex(float fHistoryArray[], float fMinTree[], float fMaxTree[], float fSumTree[], unsigned int uiArraySize)
+{
+
+	_fHistoryArray = fHistoryArray;
+	_fMinTree = fMinTree;
+	_fMaxTree = fMaxTree;
+	_fSumTree = fSumTree;
+	_uiSize = uiArraySize;
+
+	Clear();
+
+}
+
+void AcksenFloatRangeIndex::Clear(void)
+{
+
+	for (unsigned int x = 0; x < _uiSize; x++)
+	{
+		_fHistoryArray[x] = 0;
+		_fMinTree[x] = 0;
+		_fMaxTree[x] = 0;
+		_fSumTree[x] = 0;
+	}
+
+	_uiCount = 0;
+	_uiOldest = 0;
+
+}
+
+void AcksenFloatRangeIndex::Build(float fValueArray[], unsigned int uiArraySize)
+{
+
+	Clear();
+
+	if (_uiSize == 0)
+	{
+		return;
+	}
+
+	// Keep only the newest values if the array is larger than the history, as Add() would
+	if (uiArraySize > _uiSize)
+	{
+		fValueArray = fValueArray + (uiArraySize - _uiSize);
+		uiArraySize = _uiSize;
+	}
+
+	for (unsigned int x = 0; x < uiArraySize; x++)
+	{
+		_fHistoryArray[x] = fValueArray[x];
+	}
+
+	// Fill in parent nodes bottom-up, each combining its two children
+	for (unsigned int x = _uiSize - 1; x > 0; x--)
+	{
+		UpdateNode(x);
+	}
+
+	_uiCount = uiArraySize;
+
+}
+
+void AcksenFloatRangeIndex::Add(float fNewValue)
+{
+
+	if (_uiSize == 0)
+	{
+		return;
+	}
+
+	if (_uiCount < _uiSize)
+	{
+		// History not yet full - write to the next free position
+		UpdateLeaf((_uiOldest + _uiCount) % _uiSize, fNewValue);
+		_uiCount++;
+	}
+	else
+	{
+		// History full - overwrite the oldest value
+		UpdateLeaf(_uiOldest, fNewValue);
+		_uiOldest = (_uiOldest + 1) % _uiSize;
+	}
+
+}
+
+unsigned int AcksenFloatRangeIndex::Count(void)
+{
+
+	return _uiCount;
+
+}
+
+bool AcksenFloatRangeIndex::QueryRange(float &fMin, float &fMax, float &fSum, unsigned int uiStart, unsigned int uiEnd)
+{
+
+	fMin = 0;
+	fMax = 0;
+	fSum = 0;
+
+	if ((uiStart >= uiEnd) || (uiEnd > _uiCount))
+	{
+		return false;
+	}
+
+	// Map the window onto the circular history - it may wrap around the end of the tree leaves
+	unsigned int uiPhysicalStart = (_uiOldest + uiStart) % _uiSize;
+	unsigned int uiLength = uiEnd - uiStart;
+
+	if ((uiPhysicalStart + uiLength) <= _uiSize)
+	{
+		QueryPhysical(fMin, fMax, fSum, uiPhysicalStart, uiPhysicalStart + uiLength);
+	}
+	else
+	{
+		float fWrapMin, fWrapMax, fWrapSum;
+
+		QueryPhysical(fMin, fMax, fSum, uiPhysicalStart, _uiSize);
+		QueryPhysical(fWrapMin, fWrapMax, fWrapSum, 0, (uiPhysicalStart + uiLength) - _uiSize);
+
+		fMin = min(fMin, fWrapMin);
+		fMax = max(fMax, fWrapMax);
+		fSum = fSum + fWrapSum;
+	}
+
+	return true;
+
+}
+
+bool AcksenFloatRangeIndex::QueryLatest(float &fMin, float &fMax, float &fAvg, float &fRange, unsigned int uiCount)
+{
+
+	float fSum;
+
+	fAvg = 0;
+	fRange = 0;
+
+	if ((uiCount > _uiCount) || !QueryRange(fMin, fMax, fSum, _uiCount - uiCount, _uiCount))
+	{
+		fMin = 0;
+		fMax = 0;
+		return false;
+	}
+
+	// Calculate the Average
+	fAvg = fSum / (float)uiCount;
+
+	// Calculate the Range
+	fRange = fMax - fMin;
+
+	return true;
+
+}
+
+void AcksenFloatRangeIndex::UpdateLeaf(unsigned int uiPosition, float fValue)
+{
+
+	_fHistoryArray[uiPosition] = fValue;
+
+	// Walk up to the root, recombining each parent from its children
+	for (unsigned int x = (_uiSize + uiPosition) / 2; x > 0; x = x / 2)
+	{
+		UpdateNode(x);
+	}
+
+}
+
+void AcksenFloatRangeIndex::UpdateNode(unsigned int uiNode)
+{
+
+	unsigned int uiLeft = 2 * uiNode;
+	unsigned int uiRight = uiLeft + 1;
+
+	_fMinTree[uiNode] = min(NodeMin(uiLeft), NodeMin(uiRight));
+	_fMaxTree[uiNode] = max(NodeMax(uiLeft), NodeMax(uiRight));
+	_fSumTree[uiNode] = NodeSum(uiLeft) + NodeSum(uiRight);
+
+}
+
+// Nodes [1, size) are held in the trees, nodes [size, 2 * size) are the history values themselves
+float AcksenFloatRangeIndex::NodeMin(unsigned int uiNode)
+{
+
+	return (uiNode >= _uiSize) ? _fHistoryArray[uiNode - _uiSize] : _fMinTree[uiNode];
+
+}
+
+float AcksenFloatRangeIndex::NodeMax(unsigned int uiNode)
+{
+
+	return (uiNode >= _uiSize) ? _fHistoryArray[uiNode - _uiSize] : _fMaxTree[uiNode];
+
+}
+
+float AcksenFloatRangeIndex::NodeSum(unsigned int uiNode)
+{
+
+	return (uiNode >= _uiSize) ? _fHistoryArray[uiNode - _uiSize] : _fSumTree[uiNode];
+
+}
+
+void AcksenFloatRangeIndex::QueryPhysical(float &fMin, float &fMax, float &fSum, unsigned int uiStart, unsigned int uiEnd)
+{
+
+	unsigned int l = _uiSize + uiStart;
+	unsigned int r = _uiSize + uiEnd;
+
+	// Min/Max are unaffected by counting a value twice, so seed them from the first leaf in the window
+	fMin = _fHistoryArray[uiStart];
+	fMax = _fHistoryArray[uiStart];
+	fSum = 0;
+
+	// Bottom-up walk, only combining nodes that lie entirely within [l, r)
+	while (l < r)
+	{
+		if (l & 1)
+		{
+			fMin = min(fMin, NodeMin(l));
+			fMax = max(fMax, NodeMax(l));
+			fSum = fSum + NodeSum(l);
+			l++;
+		}
+		if (r & 1)
+		{
+			r--;
+			fMin = min(fMin, NodeMin(r));
+			fMax = max(fMax, NodeMax(r));
+			fSum = fSum + NodeSum(r);
+		}
+
+		l = l / 2;
+		r = r / 2;
+	}
+
+}
+
+AcksenIntRollingMedian::AcksenIntRollingMedian(int iWindowArray[], int iSortedArray[], uint8_t uiArraySize)
+{
+
+	_iWindowArray = iWindowArray;
+	_iSortedArray = iSortedArray;
+	_uiSize = uiArraySize;
+
+	Clear();
+
+}
+
+void AcksenIntRollingMedian::Clear(void)
+{
+
+	_uiCount = 0;
+	_uiOldest = 0;
+
+}
+
+void AcksenIntRollingMedian::Add(int iNewValue)
+{
+
+	uint8_t uiPosition;
+
+	if (_uiSize == 0)
+	{
+		return;
+	}
+
+	if (_uiCount < _uiSize)
+	{
+		// Window not yet full - store at the next free position
+		_iWindowArray[(_uiOldest + _uiCount) % _uiSize] = iNewValue;
+		_uiCount++;
+	}
+	else
+	{
+		// Window full - remove the oldest value from the sorted copy, closing the gap
+		uiPosition = FindSortedPosition(_iWindowArray[_uiOldest]);
+
+		for (uint8_t x = uiPosition; x < (_uiCount - 1); x++)
+		{
+			_iSortedArray[x] = _iSortedArray[x + 1];
+		}
+
+		// Overwrite the oldest value in the window
+		_iWindowArray[_uiOldest] = iNewValue;
+		_uiOldest = (_uiOldest + 1) % _uiSize;
+	}
+
+	// Insert new value into the sorted copy, opening a gap at its position
+	uiPosition = FindSortedPosition(iNewValue);
+
+	for (uint8_t x = _uiCount - 1; x > uiPosition; x--)
+	{
+		_iSortedArray[x] = _iSortedArray[x - 1];
+	}
+
+	_iSortedArray[uiPosition] = iNewValue;
+
+}
+
+uint8_t AcksenIntRollingMedian::Count(void)
+{
+
+	return _uiCount;
+
+}
+
+float AcksenIntRollingMedian::GetMedian(void)
+{
+
+	if (_uiCount == 0)
+	{
+		return 0;
+	}
+
+	if (_uiCount & 1)
+	{
+		return (float)_iSortedArray[_uiCount / 2];
+	}
+
+	return ((float)_iSortedArray[(_uiCount / 2) - 1] + (float)_iSortedArray[_uiCount / 2]) / 2;
+
+}
+
+int AcksenIntRollingMedian::GetPercentile(uint8_t uiPercent)
+{
+
+	unsigned int uiRank;
+
+	if (_uiCount == 0)
+	{
+		return 0;
+	}
+
+	if (uiPercent > 100)
+	{
+		uiPercent = 100;
+	}
+
+	// Nearest-rank: the smallest value with at least uiPercent% of samples at or below it
+	uiRank = (((unsigned int)uiPercent * _uiCount) + 99) / 100;
+
+	if (uiRank == 0)
+	{
+		uiRank = 1;
+	}
+
+	return _iSortedArray[uiRank - 1];
+
+}
+
+uint8_t AcksenIntRollingMedian::FindSortedPosition(int iValue)
+{
+
+	// Binary search for the first value not less than iValue.
+	// The final slot is excluded, as it is either free or holds the largest value, so is the right answer when nothing earlier matches
+	uint8_t uiLow = 0;
+	uint8_t uiHigh = _uiCount - 1;
+
+	while (uiLow < uiHigh)
+	{
+		uint8_t uiMid = uiLow + ((uiHigh - uiLow) / 2);
+
+		if (_iSortedArray[uiMid] < iValue)
+		{
+			uiLow = uiMid + 1;
+		}
+		else
+		{
+			uiHigh = uiMid;
+		}
+	}
+
+	return uiLow;
+
+}
+
+AcksenFloatRollingMedian::AcksenFloatRollingMedian(float fWindowArray[], float fSortedArray[], uint8_t uiArraySize)
+{
+
+	_fWindowArray = fWindowArray;
+	_fSortedArray = fSortedArray;
+	_uiSize = uiArraySize;
+
+	Clear();
+
+}
+
+void AcksenFloatRollingMedian::Clear(void)
+{
+
+	_uiCount = 0;
+	_uiOldest = 0;
+
+}
+
+void AcksenFloatRollingMedian::Add(float fNewValue)
+{
+
+	uint8_t uiPosition;
+
+	// NaN cannot be ordered, and would corrupt the sorted copy - treat it as a failed reading and skip it
+	if ((_uiSize == 0) || isnan(fNewValue))
+	{
+		return;
+	}
+
+	if (_uiCount < _uiSize)
+	{
+		// Window not yet full - store at the next free position
+		_fWindowArray[(_uiOldest + _uiCount) % _uiSize] = fNewValue;
+		_uiCount++;
+	}
+	else
+	{
+		// Window full - remove the oldest value from the sorted copy, closing the gap
+		uiPosition = FindSortedPosition(_fWindowArray[_uiOldest]);
+
+		for (uint8_t x = uiPosition; x < (_uiCount - 1); x++)
+		{
+			_fSortedArray[x] = _fSortedArray[x + 1];
+		}
+
+		// Overwrite the oldest value in the window
+		_fWindowArray[_uiOldest] = fNewValue;
+		_uiOldest = (_uiOldest + 1) % _uiSize;
+	}
+
+	// Insert new value into the sorted copy, opening a gap at its position
+	uiPosition = FindSortedPosition(fNewValue);
+
+	for (uint8_t x = _uiCount - 1; x > uiPosition; x--)
+	{
+		_fSortedArray[x] = _fSortedArray[x - 1];
+	}
+
+	_fSortedArray[uiPosition] = fNewValue;
+
+}
+
+uint8_t AcksenFloatRollingMedian::Count(void)
+{
+
+	return _uiCount;
+
+}
+
+float AcksenFloatRollingMedian::GetMedian(void)
+{
+
+	if (_uiCount == 0)
+	{
+		return 0;
+	}
+
+	if (_uiCount & 1)
+	{
+		return _fSortedArray[_uiCount / 2];
+	}
+
+	return (_fSortedArray[(_uiCount / 2) - 1] + _fSortedArray[_uiCount / 2]) / 2;
+
+}
+
+float AcksenFloatRollingMedian::GetPercentile(uint8_t uiPercent)
+{
+
+	unsigned int uiRank;
+
+	if (_uiCount == 0)
+	{
+		return 0;
+	}
+
+	if (uiPercent > 100)
+	{
+		uiPercent = 100;
+	}
+
+	// Nearest-rank: the smallest value with at least uiPercent% of samples at or below it
+	uiRank = (((unsigned int)uiPercent * _uiCount) + 99) / 100;
+
+	if (uiRank == 0)
+	{
+		uiRank = 1;
+	}
+
+	return _fSortedArray[uiRank - 1];
+
+}
+
+uint8_t AcksenFloatRollingMedian::FindSortedPosition(float fValue)
+{
+
+	// Binary search for the first value not less than fValue.
+	// The final slot is excluded, as it is either free or holds the largest value, so is the right answer when nothing earlier matches
+	uint8_t uiLow = 0;
+	uint8_t uiHigh = _uiCount - 1;
+
+	while (uiLow < uiHigh)
+	{
+		uint8_t uiMid = uiLow + ((uiHigh - uiLow) / 2);
+
+		if (_fSortedArray[uiMid] < fValue)
+		{
+			uiLow = uiMid + 1;
+		}
+		else
+		{
+			uiHigh = uiMid;
+		}
+	}
+
+	return uiLow;
+
 }
\ No newline at end of file
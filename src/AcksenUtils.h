@@ -19,8 +19,12 @@ Neither the name of the copyright holder nor the names of its contributors may b
 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ***********************************************************/
 
-// Acksen Utilities Library v1.4.0
+// Acksen Utilities Library v1.5.0
 
+// v1.5.0	19 Oct 2026
+// - Add AcksenFloatRangeIndex class for min/max/sum queries over any window of a history buffer
+// - Add AcksenIntRollingMedian and AcksenFloatRollingMedian classes for rolling median/percentile filters
+//
 // v1.4.0	25 Jul 2022
 // - Add licence, other cosmetic/comments changes for preparation for open source release
 //
@@ -41,7 +45,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #ifndef AcksenUtils_h
 #define AcksenUtils_h
 
-#define AcksenUtils_ver		140						///< Constant used to set the present library version. Can be used to ensure any code using this library, is correctly updated with necessary changes in subsequent versions, before compilation.
+#define AcksenUtils_ver		150						///< Constant used to set the present library version. Can be used to ensure any code using this library, is correctly updated with necessary changes in subsequent versions, before compilation.
 
 // Constants
 #define TEMP_UNITS_CELSIUS						0	///< Set temperature units to Celsius.  Used as a constant within code that includes this library.
@@ -326,6 +330,313 @@ protected:
   
 };
 
+/**************************************************************************/
+/*! 
+    @brief  Class that indexes a float history buffer, so that the Minimum, Maximum
+			and Sum of any window of samples can be found without rescanning the window.
+			Uses a segment tree held in caller supplied arrays - no dynamic memory is used.
+			Queries cost O(log n), and adding a new sample costs O(log n).
+*/
+/**************************************************************************/
+
+class AcksenFloatRangeIndex
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+            Sets up the range index using caller supplied history and tree storage.
+    @param  fHistoryArray[]
+            Array of floats used to store the history samples.  Must hold uiArraySize values.
+    @param  fMinTree[]
+            Array of floats used to store the Minimum tree.  Must hold uiArraySize values.
+    @param  fMaxTree[]
+            Array of floats used to store the Maximum tree.  Must hold uiArraySize values.
+    @param  fSumTree[]
+            Array of floats used to store the Sum tree.  Must hold uiArraySize values.
+			The history and three trees together need 16 bytes per sample, four times the size of the history itself.
+			Size the history with care on 8-bit AVR platforms - 255 samples needs around 4 KB, more than an Uno has.
+    @param  uiArraySize
+            Maximum number of samples held in the history.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenFloatRangeIndex(float fHistoryArray[], float fMinTree[], float fMaxTree[], float fSumTree[], unsigned int uiArraySize);
+
+/**************************************************************************/
+/*!
+    @brief  Remove all samples from the history.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Clear(void);
+
+/**************************************************************************/
+/*!
+    @brief  Rebuild the index from an existing float array, in O(n).
+			Any samples already held are discarded.
+    @param  fValueArray[]
+            Array of floats to index, oldest value first.
+    @param  uiArraySize
+            Size of float array being passed through.  If larger than the index size, the oldest values are dropped.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Build(float fValueArray[], unsigned int uiArraySize);
+
+/**************************************************************************/
+/*!
+    @brief  Add a new sample to the end of the history, in O(log n).
+			Once the history is full, the oldest sample will be discarded.
+    @param  fNewValue
+            New float value to add to the history.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Add(float fNewValue);
+
+/**************************************************************************/
+/*!
+    @brief  Return the number of samples presently held in the history.
+    @return Number of samples held.
+*/
+/**************************************************************************/
+	unsigned int Count(void);
+
+/**************************************************************************/
+/*!
+    @brief  Find the Minimum, Maximum and Sum for samples [uiStart, uiEnd) of the history.
+			Sample 0 is the oldest sample held.
+    @param  &fMin
+            Pointer to a float that will return the Minimum value in the window.
+    @param  &fMax
+            Pointer to a float that will return the Maximum value in the window.
+    @param  &fSum
+            Pointer to a float that will return the Sum of the values in the window.
+    @param  uiStart
+            Position of the first sample in the window.
+    @param  uiEnd
+            Position one past the last sample in the window.
+    @return True if the window was valid, False if it was empty or outside the history.
+*/
+/**************************************************************************/
+	bool QueryRange(float &fMin, float &fMax, float &fSum, unsigned int uiStart, unsigned int uiEnd);
+
+/**************************************************************************/
+/*!
+    @brief  Find the Minimum, Maximum, Mean Average and Range for the most recent samples in the history.
+			Equivalent to calling CalculateFloatArrayStatistics over the last uiCount samples.
+    @param  &fMin
+            Pointer to a float that will return the Minimum value in the window.
+    @param  &fMax
+            Pointer to a float that will return the Maximum value in the window.
+    @param  &fAvg
+            Pointer to a float that will return the Mean Average value in the window.
+    @param  &fRange
+            Pointer to a float that will return the Range of the window.
+    @param  uiCount
+            Number of most recent samples to include in the window.
+    @return True if the window was valid, False if it was empty or larger than the history.
+*/
+/**************************************************************************/
+	bool QueryLatest(float &fMin, float &fMax, float &fAvg, float &fRange, unsigned int uiCount);
+
+protected:
+
+	void UpdateLeaf(unsigned int uiPosition, float fValue);
+	void UpdateNode(unsigned int uiNode);
+	float NodeMin(unsigned int uiNode);
+	float NodeMax(unsigned int uiNode);
+	float NodeSum(unsigned int uiNode);
+	void QueryPhysical(float &fMin, float &fMax, float &fSum, unsigned int uiStart, unsigned int uiEnd);
+
+	float *_fHistoryArray;
+	float *_fMinTree;
+	float *_fMaxTree;
+	float *_fSumTree;
+	unsigned int _uiSize;
+	unsigned int _uiCount;
+	unsigned int _uiOldest;
+
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Class that provides a rolling median/percentile filter over the last n int samples.
+			Keeps a sorted copy of the window alongside it, so each new sample is placed with a
+			binary search and a single shift of the sorted copy, rather than a full re-sort.
+			Uses caller supplied arrays - no dynamic memory is used.
+*/
+/**************************************************************************/
+
+class AcksenIntRollingMedian
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+            Sets up the rolling median filter using caller supplied storage.
+    @param  iWindowArray[]
+            Array of ints used to store the window in arrival order.  Must hold uiArraySize values.
+    @param  iSortedArray[]
+            Array of ints used to store the sorted copy of the window.  Must hold uiArraySize values.
+    @param  uiArraySize
+            Number of samples in the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenIntRollingMedian(int iWindowArray[], int iSortedArray[], uint8_t uiArraySize);
+
+/**************************************************************************/
+/*!
+    @brief  Remove all samples from the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Clear(void);
+
+/**************************************************************************/
+/*!
+    @brief  Add a new sample to the window.
+			Once the window is full, the oldest sample will be discarded.
+    @param  iNewValue
+            New int value to add to the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Add(int iNewValue);
+
+/**************************************************************************/
+/*!
+    @brief  Return the number of samples presently held in the window.
+    @return Number of samples held.
+*/
+/**************************************************************************/
+	uint8_t Count(void);
+
+/**************************************************************************/
+/*!
+    @brief  Return the median of the samples in the window.
+			Where an even number of samples is held, the mean of the two middle samples is returned.
+    @return Median value, or 0 if the window is empty.
+*/
+/**************************************************************************/
+	float GetMedian(void);
+
+/**************************************************************************/
+/*!
+    @brief  Return a percentile of the samples in the window, using the nearest-rank method.
+    @param  uiPercent
+            Percentile to return, from 0 to 100.  0 returns the Minimum and 100 the Maximum.
+    @return Percentile value, or 0 if the window is empty.
+*/
+/**************************************************************************/
+	int GetPercentile(uint8_t uiPercent);
+
+protected:
+
+	uint8_t FindSortedPosition(int iValue);
+
+	int *_iWindowArray;
+	int *_iSortedArray;
+	uint8_t _uiSize;
+	uint8_t _uiCount;
+	uint8_t _uiOldest;
+
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Class that provides a rolling median/percentile filter over the last n float samples.
+			Keeps a sorted copy of the window alongside it, so each new sample is placed with a
+			binary search and a single shift of the sorted copy, rather than a full re-sort.
+			Uses caller supplied arrays - no dynamic memory is used.
+*/
+/**************************************************************************/
+
+class AcksenFloatRollingMedian
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+            Sets up the rolling median filter using caller supplied storage.
+    @param  fWindowArray[]
+            Array of floats used to store the window in arrival order.  Must hold uiArraySize values.
+    @param  fSortedArray[]
+            Array of floats used to store the sorted copy of the window.  Must hold uiArraySize values.
+    @param  uiArraySize
+            Number of samples in the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenFloatRollingMedian(float fWindowArray[], float fSortedArray[], uint8_t uiArraySize);
+
+/**************************************************************************/
+/*!
+    @brief  Remove all samples from the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Clear(void);
+
+/**************************************************************************/
+/*!
+    @brief  Add a new sample to the window.
+			Once the window is full, the oldest sample will be discarded.
+			NaN values (e.g. a failed sensor read) are ignored, and leave the window unchanged.
+    @param  fNewValue
+            New float value to add to the window.
+    @return No return value.
+*/
+/**************************************************************************/
+	void Add(float fNewValue);
+
+/**************************************************************************/
+/*!
+    @brief  Return the number of samples presently held in the window.
+    @return Number of samples held.
+*/
+/**************************************************************************/
+	uint8_t Count(void);
+
+/**************************************************************************/
+/*!
+    @brief  Return the median of the samples in the window.
+			Where an even number of samples is held, the mean of the two middle samples is returned.
+    @return Median value, or 0 if the window is empty.
+*/
+/**************************************************************************/
+	float GetMedian(void);
+
+/**************************************************************************/
+/*!
+    @brief  Return a percentile of the samples in the window, using the nearest-rank method.
+    @param  uiPercent
+            Percentile to return, from 0 to 100.  0 returns the Minimum and 100 the Maximum.
+    @return Percentile value, or 0 if the window is empty.
+*/
+/**************************************************************************/
+	float GetPercentile(uint8_t uiPercent);
+
+protected:
+
+	uint8_t FindSortedPosition(float fValue);
+
+	float *_fWindowArray;
+	float *_fSortedArray;
+	uint8_t _uiSize;
+	uint8_t _uiCount;
+	uint8_t _uiOldest;
+
+};
+
 #endif
 
 